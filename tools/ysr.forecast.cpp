@@ -0,0 +1,185 @@
+/**
+ * ysr.forecast - circulating supply and unlock curve of a ystar.token symbol.
+ *
+ * Reads a plain text dump of the tables of one symbol, evaluates every acclock row
+ * with the lock math of the contract (ystar.token.lock.hpp) in parallel, and prints
+ * the aggregated curve as csv: `time,locked,circulating`.
+ *
+ * Build:  g++ -std=c++17 -O2 -pthread -I.. ysr.forecast.cpp -o ysr.forecast
+ * Usage:  ysr.forecast <dump> <from> <step> <steps> [threads]
+ *
+ * Dump lines, one row each, `#` starts a comment:
+ *    stat    <supply> <extime>
+ *    rule    <lockruleid> <base> <period> <time,time,...> <pct,pct,...>
+ *    linrule <lockruleid> <start> <cliff> <duration> <granularity>
+ *    lock    <lockruleid> <quantity>
+ *    numlock <quantity>
+ */
+#include <ystar.token.lock.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct lockrule {
+   std::vector<uint64_t>   times;
+   std::vector<uint16_t>   pcts;
+   uint32_t                base = 0;
+   uint32_t                period = 0;
+};
+
+struct linrule {
+   uint64_t                start = 0;
+   uint64_t                cliff = 0;
+   uint64_t                duration = 0;
+   uint64_t                granularity = 0;
+};
+
+struct acclock {
+   uint32_t                lockruleid = 0;
+   int64_t                 quantity = 0;
+};
+
+struct snapshot {
+   int64_t                 supply = 0;
+   uint64_t                extime = 0;
+   int64_t                 numlocked = 0;
+   std::unordered_map<uint32_t, lockrule>   rules;
+   std::unordered_map<uint32_t, linrule>    linrules;
+   std::vector<acclock>                     locks;
+};
+
+template<typename T>
+static std::vector<T> split_list( const std::string& s ) {
+   std::vector<T> out;
+   std::stringstream ss( s );
+   std::string item;
+   while( std::getline( ss, item, ',' ) )
+      out.push_back( (T)std::stoull( item ) );
+   return out;
+}
+
+static bool load_snapshot( const char* path, snapshot& snap ) {
+   std::ifstream in( path );
+   if( !in ) {
+      std::cerr << "cannot open " << path << std::endl;
+      return false;
+   }
+
+   std::string line;
+   size_t lineno = 0;
+   while( std::getline( in, line ) ) {
+      lineno++;
+      auto hash = line.find( '#' );
+      if( hash != std::string::npos )
+         line.resize( hash );
+      std::istringstream ls( line );
+      std::string kind;
+      if( !(ls >> kind) )
+         continue;
+
+      bool ok = false;
+      if( kind == "stat" ) {
+         ok = bool(ls >> snap.supply >> snap.extime);
+      } else if( kind == "rule" ) {
+         uint32_t id;
+         lockrule r;
+         std::string times, pcts;
+         ok = bool(ls >> id >> r.base >> r.period >> times >> pcts);
+         if( ok ) {
+            r.times = split_list<uint64_t>( times );
+            r.pcts  = split_list<uint16_t>( pcts );
+            ok = r.times.size() >= 1 && r.times.size() == r.pcts.size() && r.base > 0
+                 && (r.times.size() > 1 || r.period > 0);
+            snap.rules[id] = r;
+         }
+      } else if( kind == "linrule" ) {
+         uint32_t id;
+         linrule r;
+         ok = bool(ls >> id >> r.start >> r.cliff >> r.duration >> r.granularity);
+         ok = ok && r.duration > 0 && r.granularity > 0;
+         snap.linrules[id] = r;
+      } else if( kind == "lock" ) {
+         acclock l;
+         ok = bool(ls >> l.lockruleid >> l.quantity);
+         snap.locks.push_back( l );
+      } else if( kind == "numlock" ) {
+         int64_t q;
+         ok = bool(ls >> q);
+         snap.numlocked += q;
+      }
+      if( !ok ) {
+         std::cerr << path << ":" << lineno << ": invalid line" << std::endl;
+         return false;
+      }
+   }
+   return true;
+}
+
+/**
+ * Same lookup order as `ystartoken_reader::get_locked_balance`: lockrule, then linrule, else fully locked.
+ */
+static int64_t locked_at( const snapshot& snap, const acclock& l, uint64_t curtime ) {
+   auto itrule = snap.rules.find( l.lockruleid );
+   if( itrule != snap.rules.end() ) {
+      const auto& r = itrule->second;
+      return ystarlock::rule_locked( l.quantity, snap.extime, curtime, r.times, r.pcts, r.base, r.period );
+   }
+   auto itlin = snap.linrules.find( l.lockruleid );
+   if( itlin != snap.linrules.end() ) {
+      const auto& r = itlin->second;
+      return ystarlock::linear_locked( l.quantity, snap.extime, curtime, r.start, r.cliff, r.duration, r.granularity );
+   }
+   return l.quantity;
+}
+
+int main( int argc, char** argv ) {
+   if( argc < 5 ) {
+      std::cerr << "usage: " << argv[0] << " <dump> <from> <step> <steps> [threads]" << std::endl;
+      return 1;
+   }
+   uint64_t from  = std::stoull( argv[2] );
+   uint64_t step  = std::stoull( argv[3] );
+   size_t   steps = std::stoull( argv[4] );
+   size_t   nthreads = argc > 5 ? std::stoull( argv[5] ) : std::thread::hardware_concurrency();
+   if( nthreads == 0 )
+      nthreads = 1;
+
+   snapshot snap;
+   if( !load_snapshot( argv[1], snap ) )
+      return 1;
+
+   //every thread sums its own slice of rows, the curves are added up afterwards
+   nthreads = std::max<size_t>( 1, std::min( nthreads, snap.locks.size() ) );
+   std::vector<std::vector<int64_t>> curves( nthreads, std::vector<int64_t>( steps, 0 ) );
+   std::vector<std::thread> workers;
+   size_t chunk = (snap.locks.size() + nthreads - 1) / nthreads;
+   for( size_t t = 0; t < nthreads; t++ ) {
+      workers.emplace_back( [&, t]() {
+         auto& curve = curves[t];
+         size_t end = std::min( snap.locks.size(), (t + 1) * chunk );
+         for( size_t no = t * chunk; no < end; no++ ) {
+            for( size_t s = 0; s < steps; s++ )
+               curve[s] += locked_at( snap, snap.locks[no], from + s * step );
+         }
+      });
+   }
+   for( auto& w : workers )
+      w.join();
+
+   std::cout << "time,locked,circulating\n";
+   for( size_t s = 0; s < steps; s++ ) {
+      int64_t locked = snap.numlocked;
+      for( const auto& curve : curves )
+         locked += curve[s];
+      std::cout << from + s * step << "," << locked << "," << snap.supply - locked << "\n";
+   }
+   return 0;
+}
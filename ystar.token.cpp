@@ -32,6 +32,7 @@ void ystartoken::create( const name& issuer, const name& ruler, const name& bigs
    });
    symkind.emplace(get_self(), [&]( auto& row ) {
       row.symno = symno;
+      row.sym.emplace( maximum_supply.symbol );
    });
 }
 
@@ -104,6 +105,39 @@ void ystartoken::close( const name& acc, const asset& value )
    del_acnts.erase( delacc );
 }
 
+void ystartoken::setautoclose( const asset& value, bool enable )
+{
+   auto sym = value.symbol;
+   check( sym.is_valid(), "invalid symbol when setautoclose" );
+   stats statstable( get_self(), sym.code().raw() );
+   const auto& st = statstable.get( sym.code().raw(), "token is not existed when setautoclose" );
+   require_auth( st.issuer );
+
+   statstable.modify( st, same_payer, [&]( auto& s ) {
+      //binary extensions are serialized in order, paused must be present before autoclose
+      if( !s.paused.has_value() )
+         s.paused.emplace( false );
+      s.autoclose.emplace( enable );
+   });
+}
+
+void ystartoken::reclaim( const std::vector<name>& accs, const asset& value )
+{
+   check( accs.size() <= 200, "too many accounts to reclaim" );
+   auto sym = value.symbol;
+   check( sym.is_valid(), "invalid symbol when reclaim" );
+   stats statstable( get_self(), sym.code().raw() );
+   const auto& st = statstable.get( sym.code().raw(), "token is not existed when reclaim" );
+   check( st.autoclose.value_or(), "autoclose is not enabled for this token" );
+
+   for(size_t no = 0; no < accs.size(); no++) {
+      accounts _acnts( get_self(), accs[no].value );
+      auto it = _acnts.find( sym.code().raw() );
+      if( it != _acnts.end() && it->balance.amount == 0 && is_reclaimable( accs[no], st ) )
+         _acnts.erase( it );
+   }
+}
+
 void ystartoken::yrctransfer( const name&    from,
                               const name&    to,
                               const asset&   quantity,
@@ -125,6 +159,7 @@ void ystartoken::yrctransfer( const name&    from,
     check( quantity.amount > 0, "must transfer positive quantity" );
     check( quantity.symbol == st.supply.symbol, "symbol or precision mismatch" );
     check( memo.size() <= 256, "memo has more than 256 bytes" );
+    check_paused( st, from );
 
     sub_balance( from, quantity );
     add_balance( to.value, sym.code().raw(), quantity, from, bcreate );
@@ -151,6 +186,7 @@ void ystartoken::transfer( const name&    from,
     check( quantity.amount > 0, "must transfer positive quantity" );
     check( quantity.symbol == st.supply.symbol, "symbol or precision mismatch" );
     check( memo.size() <= 256, "memo has more than 256 bytes" );
+    check_paused( st, from );
 
     sub_balance( from, quantity );
     add_balance( to.value, sym.code().raw(), quantity, from, bcreate );
@@ -170,6 +206,13 @@ void ystartoken::sub_balance( const name& owner, const asset& value ) {
    from_acnts.modify( from, owner, [&]( auto& a ) {
       a.balance -= value;
    });
+
+   if( from.balance.amount == 0 ) {
+      stats statstable( get_self(), value.symbol.code().raw() );
+      const auto& st = statstable.get( value.symbol.code().raw(), "token is not existed" );
+      if( st.autoclose.value_or() && is_reclaimable( owner, st ) )
+         from_acnts.erase( from );
+   }
 }
 
 void ystartoken::add_balance( uint64_t namevalue, uint64_t symbol, const asset& value, const name& ram_payer, bool bcreate )
@@ -230,6 +273,61 @@ void ystartoken::unfreezeacc( const name& acc, const asset& value )
    _accfrozen.erase( it );
 }
 
+void ystartoken::pause( const asset& value ) {
+   auto sym = value.symbol;
+   check( sym.is_valid(), "invalid symbol when pause" );
+   stats statstable( get_self(), sym.code().raw() );
+   const auto& st = statstable.get( sym.code().raw(), "token is not existed when pause" );
+   require_auth( st.freezer );
+   check( !st.paused.value_or(), "token is already paused" );
+
+   statstable.modify( st, same_payer, [&]( auto& s ) {
+      s.paused.emplace( true );
+   });
+}
+
+void ystartoken::unpause( const asset& value ) {
+   auto sym = value.symbol;
+   check( sym.is_valid(), "invalid symbol when unpause" );
+   stats statstable( get_self(), sym.code().raw() );
+   const auto& st = statstable.get( sym.code().raw(), "token is not existed when unpause" );
+   require_auth( st.unfreezer );
+   check( st.paused.value_or(), "token is not paused" );
+
+   statstable.modify( st, same_payer, [&]( auto& s ) {
+      s.paused.emplace( false );
+   });
+}
+
+void ystartoken::addpauseacc( const name& user, const asset& value ) {
+   auto sym = value.symbol;
+   check( sym.is_valid(), "invalid symbol when addpauseacc" );
+   stats statstable( get_self(), sym.code().raw() );
+   const auto& st = statstable.get( sym.code().raw(), "token is not existed when addpauseacc" );
+   require_auth( st.freezer );
+
+   check( is_account( user ), "Account does not exist when addpauseacc");
+   pauseaccs _pauseacc( get_self(), sym.code().raw() );
+   auto it = _pauseacc.find( user.value );
+   check( it == _pauseacc.end(), "user has already been allowed while paused" );
+
+   _pauseacc.emplace(st.freezer, [&](auto &row) {
+      row.user = user;
+   });
+}
+
+void ystartoken::rmvpauseacc( const name& user, const asset& value ) {
+   auto sym = value.symbol;
+   check( sym.is_valid(), "invalid symbol when rmvpauseacc" );
+   stats statstable( get_self(), sym.code().raw() );
+   const auto& st = statstable.get( sym.code().raw(), "token is not existed when rmvpauseacc" );
+   require_auth( st.freezer );
+
+   pauseaccs _pauseacc( get_self(), sym.code().raw() );
+   const auto& it = _pauseacc.get( user.value, "is not allowed while paused" );
+   _pauseacc.erase( it );
+}
+
 void ystartoken::addaccbig( const name& user, const asset& value ) {
    auto sym = value.symbol;
    check( sym.is_valid(), "invalid symbol when addaccbig" );
@@ -282,6 +380,8 @@ void ystartoken::addrule( uint32_t lockruleid, const std::vector<uint64_t>& time
    lockrules _lockrule( get_self(), sym.code().raw() );
    auto itrule = _lockrule.find(lockruleid);
    check( itrule == _lockrule.end(), "the id already existed in rule table" ); 
+   linrules _linrule( get_self(), sym.code().raw() );
+   check( _linrule.find(lockruleid) == _linrule.end(), "the id already existed in linear rule table" );
 
    for( size_t i = 0; i < times.size(); i++ ) {
       if( i == 0 ){
@@ -303,6 +403,33 @@ void ystartoken::addrule( uint32_t lockruleid, const std::vector<uint64_t>& time
    });
 }
 
+void ystartoken::addlinrule( uint32_t lockruleid, uint32_t start, uint32_t cliff, uint32_t duration,
+                             uint32_t granularity, const asset& value )
+{
+   auto sym = value.symbol;
+   check( sym.is_valid(), "invalid symbol when addlinrule" );
+   stats statstable( get_self(), sym.code().raw() );
+   const auto& st = statstable.get( sym.code().raw(), "token is not existed when addlinrule" );
+   require_auth( st.ruler );
+
+   check( duration > 0, "invalidate duration" );
+   check( granularity > 0 && granularity <= duration, "invalidate granularity" );
+   check( cliff <= duration, "cliff should not be later than duration" );
+
+   lockrules _lockrule( get_self(), sym.code().raw() );
+   check( _lockrule.find(lockruleid) == _lockrule.end(), "the id already existed in rule table" );
+   linrules _linrule( get_self(), sym.code().raw() );
+   check( _linrule.find(lockruleid) == _linrule.end(), "the id already existed in linear rule table" );
+
+   _linrule.emplace(st.ruler, [&](auto &row) {
+      row.lockruleid   = lockruleid;
+      row.start        = start;
+      row.cliff        = cliff;
+      row.duration     = duration;
+      row.granularity  = granularity;
+   });
+}
+
 void ystartoken::batchtrans(const name& from, const std::vector<name>& accs,
                             const std::vector<int64_t>& amounts, const asset& value, const string& memo)
 {
@@ -315,6 +442,9 @@ void ystartoken::batchtrans(const name& from, const std::vector<name>& accs,
    stats statstable( get_self(), sym.code().raw() );
    const auto& st = statstable.get( sym.code().raw(), "token is not existed when batchtrans." );
    check( sym == st.supply.symbol, "symbol or precision mismatch" );
+   check_paused( st, from );
+   //with autoclose, drained holders have no row, recreate it at the cost of the sender
+   bool bcreate = st.autoclose.value_or();
 
    int64_t all_amount = 0;
    for(size_t no = 0; no < amounts.size(); no++) {
@@ -328,12 +458,222 @@ void ystartoken::batchtrans(const name& from, const std::vector<name>& accs,
             a.balance.amount += amounts[no];
          });
          all_amount += amounts[no];
+      } else if( bcreate && amounts[no] > 0 && is_account( accs[no]) ) {
+         to_acnts.emplace( from, [&]( auto& a ){
+            a.balance = asset( amounts[no], sym );
+         });
+         all_amount += amounts[no];
       }
    }
    asset subasset( all_amount, sym );
    sub_balance( from, subasset );
 }
 
+void ystartoken::batchpack( const name& from, const asset& value, bool varamount,
+                            const string& memo, ignore<std::vector<char>> records )
+{
+   require_auth( from );
+
+   check( memo.size() <= 256, "memo has more than 256 bytes" );
+   auto sym = value.symbol;
+   check( sym.is_valid(), "invalid symbol when batchpack" );
+   stats statstable( get_self(), sym.code().raw() );
+   const auto& st = statstable.get( sym.code().raw(), "token is not existed when batchpack." );
+   check( sym == st.supply.symbol, "symbol or precision mismatch" );
+   check_paused( st, from );
+
+   int64_t all_amount = credit_packed( get_datastream(), sym, varamount, from, st.autoclose.value_or() );
+   asset subasset( all_amount, sym );
+   sub_balance( from, subasset );
+}
+
+int64_t ystartoken::credit_packed( datastream<const char*>& ds, const symbol& sym, bool varamount,
+                                  const name& ram_payer, bool bcreate )
+{
+   unsigned_int size;
+   ds >> size;
+   check( ds.remaining() == size.value, "packed records size mismatch" );
+   if( !varamount ) {
+      check( size.value % (sizeof(uint64_t) + sizeof(int64_t)) == 0, "packed records are not fixed width" );
+   }
+
+   int64_t all_amount = 0;
+   while( ds.remaining() > 0 ) {
+      uint64_t acc = 0;
+      int64_t amount = 0;
+      ds >> acc;
+      if( varamount ) {
+         uint64_t v = 0;
+         uint8_t  b = 0;
+         uint32_t shift = 0;
+         do {
+            //amounts are at most 62 bits, a tenth byte can only be an overlong encoding
+            check( shift < 63, "varuint64 amount is too long" );
+            ds.get( b );
+            v |= uint64_t(b & 0x7f) << shift;
+            shift += 7;
+         } while( b & 0x80 );
+         check( v <= (uint64_t)asset::max_amount, "amount is too big" );
+         amount = (int64_t)v;
+      } else {
+         ds >> amount;
+      }
+
+      accounts to_acnts( get_self(), acc );
+      auto to = to_acnts.find( sym.code().raw() );
+      if( to != to_acnts.end() && amount > 0 && is_account( name(acc) ) ) {
+         to_acnts.modify( to, same_payer, [&]( auto& a ) {
+            a.balance.amount += amount;
+         });
+         all_amount += amount;
+         check( all_amount <= asset::max_amount, "batch amount overflow" );
+      } else if( bcreate && amount > 0 && is_account( name(acc) ) ) {
+         to_acnts.emplace( ram_payer, [&]( auto& a ){
+            a.balance = asset( amount, sym );
+         });
+         all_amount += amount;
+         check( all_amount <= asset::max_amount, "batch amount overflow" );
+      }
+   }
+   return all_amount;
+}
+
+void ystartoken::addjob( uint32_t jobid, const name& from, const asset& value, const string& memo )
+{
+   require_auth( from );
+
+   check( memo.size() <= 256, "memo has more than 256 bytes" );
+   auto sym = value.symbol;
+   check( sym.is_valid(), "invalid symbol when addjob" );
+   stats statstable( get_self(), sym.code().raw() );
+   const auto& st = statstable.get( sym.code().raw(), "token is not existed when addjob." );
+   check( sym == st.supply.symbol, "symbol or precision mismatch" );
+
+   batchjobs _batchjob( get_self(), sym.code().raw() );
+   auto itjob = _batchjob.find( jobid );
+   check( itjob == _batchjob.end(), "the id already existed in job table" );
+
+   _batchjob.emplace(from, [&](auto &row) {
+      row.jobid     = jobid;
+      row.from      = from;
+      row.remaining = asset( 0, st.supply.symbol );
+      row.cursor    = 0;
+      row.size      = 0;
+      row.memo      = memo;
+   });
+}
+
+void ystartoken::addjobitems( uint32_t jobid, const std::vector<name>& accs,
+                              const std::vector<int64_t>& amounts, const asset& value )
+{
+   check( accs.size() > 0, "accounts of job is empty" );
+   check( accs.size() == amounts.size(), "accounts and quantities in different size" );
+   auto sym = value.symbol;
+   check( sym.is_valid(), "invalid symbol when addjobitems" );
+   batchjobs _batchjob( get_self(), sym.code().raw() );
+   const auto& job = _batchjob.get( jobid, "job is not existed when addjobitems" );
+   require_auth( job.from );
+   stats statstable( get_self(), sym.code().raw() );
+   const auto& st = statstable.get( sym.code().raw(), "token is not existed when addjobitems." );
+   check_paused( st, job.from );
+   check( (uint64_t)job.size + accs.size() <= 0xffffffff, "too many entries in job" );
+
+   jobentries _jobentry( get_self(), sym.code().raw() );
+   int64_t all_amount = 0;
+   for(size_t no = 0; no < accs.size(); no++) {
+      check( amounts[no] > 0, "must transfer positive quantity" );
+      check( is_account( accs[no] ), "to account does not exist" );
+      all_amount += amounts[no];
+      check( all_amount <= asset::max_amount, "job amount overflow" );
+      //the payee row is created now at the cost of the sender, processjob cannot bill anyone
+      accounts to_acnts( get_self(), accs[no].value );
+      if( to_acnts.find( sym.code().raw() ) == to_acnts.end() ) {
+         to_acnts.emplace( job.from, [&]( auto& a ){
+            a.balance = asset( 0, job.remaining.symbol );
+         });
+      }
+      _jobentry.emplace(job.from, [&](auto &row) {
+         row.key    = ((uint64_t)jobid << 32) | (job.size + no);
+         row.user   = accs[no];
+         row.amount = amounts[no];
+      });
+   }
+   sub_balance( job.from, asset( all_amount, job.remaining.symbol ) );
+
+   _batchjob.modify( job, same_payer, [&](auto &row) {
+      row.size      += accs.size();
+      row.remaining.amount += all_amount;
+   });
+}
+
+void ystartoken::processjob( uint32_t jobid, const asset& value, uint32_t count )
+{
+   check( count > 0, "count must be a positive number" );
+   auto sym = value.symbol;
+   check( sym.is_valid(), "invalid symbol when processjob" );
+   batchjobs _batchjob( get_self(), sym.code().raw() );
+   const auto& job = _batchjob.get( jobid, "job is not existed when processjob" );
+   check( sym == job.remaining.symbol, "symbol or precision mismatch" );
+   check( job.cursor < job.size, "no entry left in job" );
+   stats statstable( get_self(), sym.code().raw() );
+   const auto& st = statstable.get( sym.code().raw(), "token is not existed when processjob." );
+   check_paused( st, job.from );
+
+   uint32_t end = job.size - job.cursor > count ? job.cursor + count : job.size;
+   int64_t paid = 0;
+   jobentries _jobentry( get_self(), sym.code().raw() );
+   auto it = _jobentry.lower_bound( ((uint64_t)jobid << 32) | job.cursor );
+   for(uint32_t no = job.cursor; no < end; no++) {
+      //never run into the entries of the next job
+      check( it != _jobentry.end() && it->key == (((uint64_t)jobid << 32) | no), "job entry is missing" );
+      accounts to_acnts( get_self(), it->user.value );
+      auto to = to_acnts.find( sym.code().raw() );
+      if( to != to_acnts.end() && is_account( it->user ) ) {
+         to_acnts.modify( to, same_payer, [&]( auto& a ) {
+            a.balance.amount += it->amount;
+         });
+         paid += it->amount;
+      }
+      it = _jobentry.erase( it );
+   }
+
+   //amounts of skipped entries stay in the job until closejob refunds them
+   _batchjob.modify( job, same_payer, [&](auto &row) {
+      row.cursor = end;
+      row.remaining.amount -= paid;
+   });
+}
+
+void ystartoken::closejob( uint32_t jobid, const asset& value, uint32_t count )
+{
+   check( count > 0, "count must be a positive number" );
+   auto sym = value.symbol;
+   check( sym.is_valid(), "invalid symbol when closejob" );
+   batchjobs _batchjob( get_self(), sym.code().raw() );
+   const auto& job = _batchjob.get( jobid, "job is not existed when closejob" );
+   check( sym == job.remaining.symbol, "symbol or precision mismatch" );
+   require_auth( job.from );
+
+   uint32_t end = job.size - job.cursor > count ? job.cursor + count : job.size;
+   jobentries _jobentry( get_self(), sym.code().raw() );
+   auto it = _jobentry.lower_bound( ((uint64_t)jobid << 32) | job.cursor );
+   for(uint32_t no = job.cursor; no < end; no++) {
+      //never run into the entries of the next job
+      check( it != _jobentry.end() && it->key == (((uint64_t)jobid << 32) | no), "job entry is missing" );
+      it = _jobentry.erase( it );
+   }
+
+   if( end < job.size ) {
+      _batchjob.modify( job, same_payer, [&](auto &row) {
+         row.cursor = end;
+      });
+      return;
+   }
+   if( job.remaining.amount > 0 )
+      add_balance( job.from.value, sym.code().raw(), job.remaining, job.from, true );
+   _batchjob.erase( job );
+}
+
 void ystartoken::locktransfer(uint32_t lockruleid, const name& from, const name& to, const asset& quantity, const string& memo) 
 {
    require_auth( from );
@@ -344,7 +684,9 @@ void ystartoken::locktransfer(uint32_t lockruleid, const name& from, const name&
    accbigs _accbig( get_self(), sym.code().raw() );
    const auto& bigacc = _accbig.get( from.value, "only bigacc can locktransfer" );
    lockrules _lockrule( get_self(), sym.code().raw() );
-   const auto& itrule = _lockrule.get( lockruleid, "lockruleid not existed in rule table" );
+   linrules _linrule( get_self(), sym.code().raw() );
+   check( _lockrule.find( lockruleid ) != _lockrule.end() || _linrule.find( lockruleid ) != _linrule.end(),
+          "lockruleid not existed in rule table" );
 
    yrctransfer( from, to, quantity, true, memo );
 
@@ -413,6 +755,84 @@ void ystartoken::lockasset( const name& acc, const asset& value, const string& m
    }
 }
 
+void ystartoken::check_paused( const currency_stat& st, const name& from )
+{
+   check( !ystartoken_reader::is_blocked_by_pause( get_self(), st, from ), "token is paused" );
+}
+
+void ystartoken::regsymno( const asset& value )
+{
+   auto sym = value.symbol;
+   check( sym.is_valid(), "invalid symbol when regsymno" );
+   stats statstable( get_self(), sym.code().raw() );
+   const auto& st = statstable.get( sym.code().raw(), "token is not existed when regsymno" );
+
+   assetkinds symkind( get_self(), get_self().value );
+   const auto& kind = symkind.get( st.symno, "symno is not existed" );
+   check( !kind.sym.has_value(), "symno has already been registered" );
+   symkind.modify( kind, same_payer, [&]( auto& row ) {
+      row.sym.emplace( st.supply.symbol );
+   });
+}
+
+void ystartoken::setextimeno( uint32_t symno, uint64_t time )
+{
+   setextime( time, asset( 0, get_symno_symbol( symno ) ) );
+}
+
+void ystartoken::freezeno( const name& acc, uint32_t symno, uint64_t time )
+{
+   freezeacc( acc, asset( 0, get_symno_symbol( symno ) ), time );
+}
+
+void ystartoken::addbigno( const name& user, uint32_t symno )
+{
+   addaccbig( user, asset( 0, get_symno_symbol( symno ) ) );
+}
+
+void ystartoken::lockno( const name& acc, uint32_t symno, int64_t amount, const string& memo )
+{
+   lockasset( acc, asset( amount, get_symno_symbol( symno ) ), memo );
+}
+
+void ystartoken::batchno( const name& from, uint32_t symno, bool varamount,
+                          const string& memo, ignore<std::vector<char>> records )
+{
+   //the records are still unread in the action data stream, batchpack reads them from there
+   batchpack( from, asset( 0, get_symno_symbol( symno ) ), varamount, memo, records );
+}
+
+symbol ystartoken::get_symno_symbol( uint32_t symno )
+{
+   assetkinds symkind( get_self(), get_self().value );
+   const auto& kind = symkind.get( symno, "symno is not existed" );
+   check( kind.sym.has_value(), "symno is not registered, call regsymno first" );
+   return kind.sym.value();
+}
+
+bool ystartoken::is_reclaimable( const name& owner, const currency_stat& st )
+{
+   auto symcode = st.supply.symbol.code().raw();
+   numlocks _numlock( get_self(), symcode );
+   if( _numlock.find( owner.value ) != _numlock.end() )
+      return false;
+
+   accfrozens _accfrozen( get_self(), symcode );
+   if( _accfrozen.find( owner.value ) != _accfrozen.end() )
+      return false;
+
+   acclocks _acclock( get_self(), owner.value + (uint64_t)(symcode & 0xf) );
+   for(auto it = _acclock.begin(); it != _acclock.end(); it++) {
+      if ( (it->symruleid >> 32) == st.symno )
+         return false;
+   }
+
+   //an open batch job still has to pay into this row
+   jobentries _jobentry( get_self(), symcode );
+   auto byuser = _jobentry.get_index<"byuser"_n>();
+   return byuser.find( owner.value ) == byuser.end();
+}
+
 bool ystartoken::is_frozen( const name& user, const asset& value )
 {
    bool isFrozen = false;
@@ -431,62 +851,7 @@ bool ystartoken::is_frozen( const name& user, const asset& value )
 }
 
 asset ystartoken::get_lock_asset( const name& user, const asset& value ) {
-   auto sym = value.symbol;
-   asset lockasset( 0, sym );
-
-   numlocks _numlock( get_self(), sym.code().raw() );
-   auto il = _numlock.find( user.value );
-   if( il != _numlock.end() )
-      lockasset.amount = il->quantity.amount;
-
-   stats statstable( get_self(), sym.code().raw() );
-   const auto& st = statstable.get( sym.code().raw(), "token is not existed" );
-   check( sym == st.supply.symbol, "symbol or precision mismatch" );
-   acclocks _acclock( get_self(), user.value  + (uint64_t)(sym.code().raw() & 0xf) );
-   uint64_t curtime = current_time_point().sec_since_epoch(); //seconds
-   for(auto it = _acclock.begin(); it != _acclock.end(); it++) {
-      int64_t amount = it->quantity;
-      uint64_t extime = st.time; //exchanging time
-
-      if ( (it->symruleid >> 32) != st.symno)
-         continue;
-
-      lockrules _lockrule( get_self(), sym.code().raw() );
-      auto itrule = _lockrule.find(it->symruleid & 0xffffffff);
-      //check(itrule != _lockrule.end(), "lockruleid not existed in rule table");
-      if ( extime == 0 || itrule == _lockrule.end() || curtime <= extime) {
-         lockasset.amount += amount;
-      } else {
-         uint32_t percent = 0;
-         if ( itrule->times.size() == 1 ) { //lock by period
-            //int64_t hour_seconds = 60*60;
-            int64_t numerator = (int64_t)curtime - (int64_t)extime - (int64_t)itrule->times[0];
-            int64_t periods = numerator / (int64_t)itrule->period;
-            if (numerator > 0 && periods >= 1) {
-               percent = itrule->pcts[0] * periods;
-               if (percent < itrule->base) {
-                  percent = itrule->base - percent;
-                  lockasset.amount += (int64_t)(((double)amount / itrule->base)*percent);
-               }
-            } else {
-               lockasset.amount += amount;
-            }
-         } else {
-            size_t n = 0;
-            for(auto itt = itrule->times.begin(); itt != itrule->times.end(); itt++) {
-               if( extime + *itt > curtime ) {
-                     break;
-               }
-               percent = itrule->pcts[n];
-               n++;
-            }
-            //check( percent>=0 && percent<=itrule->base, "invalidate lock percentage" );
-            percent = itrule->base - percent;
-            lockasset.amount += (int64_t)(((double)amount / itrule->base)*percent);
-         }
-      }
-   }
-   //print(lockasset.amount);
-
+   auto lockasset = ystartoken_reader::get_locked_balance( get_self(), user, value.symbol.code() );
+   check( value.symbol == lockasset.symbol, "symbol or precision mismatch" );
    return lockasset;
 }
@@ -5,6 +5,8 @@
 #include <eosio/system.hpp>
 
 #include <string>
+
+#include <ystar.token.tables.hpp>
 using namespace eosio;
 
 using std::string;
@@ -91,6 +93,28 @@ class [[eosio::contract("ystar.token")]] ystartoken : public contract {
       void close( const name&    acc,
                   const asset&   value );
       
+      /**
+       * This action will set whether the zero balance rows of a token are erased automatically.
+       * While it is enabled `batchtrans` and `batchpack` recreate a missing row at the cost of
+       * the sender. Rows still referred by an open batch job entry are never erased.
+       *
+       * @param value - in order to get the symbol of currency,
+       * @param enable - erase zero balance rows or not.
+       */
+      [[eosio::action]]
+      void setautoclose( const asset& value, bool enable );
+
+      /**
+       * This action will erase the zero balance rows of a batch of accounts, anyone can call it
+       * once autoclose is enabled. Rows still referred by a lock or a freeze are skipped.
+       *
+       * @param accs - which accounts,
+       * @param value - in order to get the symbol of currency.
+       */
+      [[eosio::action]]
+      void reclaim( const std::vector<name>& accs,
+                    const asset&   value );
+
       /**
        * Allows `from` account to transfer to `to` account the `quantity` tokens.
        * One account is debited and the other is credited with quantity tokens.
@@ -147,6 +171,42 @@ class [[eosio::contract("ystar.token")]] ystartoken : public contract {
       void unfreezeacc( const name&    acc,
                         const asset&   value );
 
+      /**
+       * This action will pause all transfers of a token, except from allow-listed accounts.
+       *
+       * @param value - in order to get the symbol of currency.
+       */
+      [[eosio::action]]
+      void pause( const asset& value );
+
+      /**
+       * This action will unpause the transfers of a token.
+       *
+       * @param value - in order to get the symbol of currency.
+       */
+      [[eosio::action]]
+      void unpause( const asset& value );
+
+      /**
+       * This action will add acc to the allow list used while the token is paused.
+       *
+       * @param user - which account,
+       * @param value - which asset.
+       */
+      [[eosio::action]]
+      void addpauseacc( const name&   user,
+                        const asset&  value );
+
+      /**
+       * This action will remove acc from the allow list used while the token is paused.
+       *
+       * @param user - which account,
+       * @param value - which asset.
+       */
+      [[eosio::action]]
+      void rmvpauseacc( const name&   user,
+                        const asset&  value );
+
       /**
        * This action will add acc to accbig.
        *
@@ -187,6 +247,26 @@ class [[eosio::contract("ystar.token")]] ystartoken : public contract {
                      const asset& value,
                      const string& desc );
 
+      /**
+       * This action will add a linear lock rule, evaluated in constant time. Nothing unlocks
+       * before `start + cliff`, after that the lock is released linearly every `granularity`
+       * seconds until `start + duration`. A zero `cliff` gives a plain linear rule.
+       *
+       * @param lockruleid - id of the lock rule, shared with the ids of addrule,
+       * @param start - seconds after the exchanging time when vesting starts,
+       * @param cliff - seconds after start before anything unlocks,
+       * @param duration - seconds after start when everything is unlocked,
+       * @param granularity - unlock step in seconds,
+       * @param value - in order to get the ruler.
+       */
+      [[eosio::action]]
+      void addlinrule( uint32_t lockruleid,
+                       uint32_t start,
+                       uint32_t cliff,
+                       uint32_t duration,
+                       uint32_t granularity,
+                       const asset& value );
+
       /**
        * This action will transfer a batch of asset.
        *
@@ -203,6 +283,81 @@ class [[eosio::contract("ystar.token")]] ystartoken : public contract {
                        const asset& value,
                        const string& memo );
 
+      /**
+       * This action will transfer a batch of asset packed in one binary blob.
+       * Every record is an 8 bytes account name followed by its amount, the amount is
+       * a fixed 8 bytes int64 or a varuint64 when `varamount` is set. The records are
+       * read in place from the action data, no vectors are materialized.
+       *
+       * @param from - transfer from which account,
+       * @param value - in order to get the symbol,
+       * @param varamount - amounts are varuint64 encoded or not,
+       * @param memo - the memo,
+       * @param records - the packed (account, amount) records.
+       */
+      [[eosio::action]]
+      void batchpack( const name&   from,
+                      const asset&  value,
+                      bool          varamount,
+                      const string& memo,
+                      ignore<std::vector<char>> records );
+
+      /**
+       * This action will create an empty batch transfer job, entries are added by `addjobitems`.
+       *
+       * @param jobid - id of the job,
+       * @param from - transfer from which account,
+       * @param value - in order to get the symbol,
+       * @param memo - the memo.
+       */
+      [[eosio::action]]
+      void addjob( uint32_t      jobid,
+                   const name&   from,
+                   const asset&  value,
+                   const string& memo );
+
+      /**
+       * This action will append entries to a batch transfer job, it can be called many times.
+       * The amount of the entries is debited from `from` at once and paid out later by `processjob`,
+       * missing payee rows are created at the cost of `from`.
+       *
+       * @param jobid - id of the job,
+       * @param accs - transfer to which accounts,
+       * @param amounts - transfer how many to every account,
+       * @param value - in order to get the symbol.
+       */
+      [[eosio::action]]
+      void addjobitems( uint32_t      jobid,
+                        const std::vector<name>& accs,
+                        const std::vector<int64_t>& amounts,
+                        const asset&  value );
+
+      /**
+       * This action will pay out the next `count` entries of a batch transfer job, anyone can call it.
+       * An entry whose row its owner has closed is skipped, its amount stays in the job.
+       *
+       * @param jobid - id of the job,
+       * @param value - in order to get the symbol,
+       * @param count - max number of entries paid in this call.
+       */
+      [[eosio::action]]
+      void processjob( uint32_t      jobid,
+                       const asset&  value,
+                       uint32_t      count );
+
+      /**
+       * This action will close a batch transfer job. Up to `count` unpaid entries are dropped,
+       * and once none is left the unpaid asset is refunded to `from` and the job erased.
+       *
+       * @param jobid - id of the job,
+       * @param value - in order to get the symbol,
+       * @param count - max number of unpaid entries dropped in this call.
+       */
+      [[eosio::action]]
+      void closejob( uint32_t      jobid,
+                     const asset&  value,
+                     uint32_t      count );
+
       /**
        * This action will transfer the locked asset.
        *
@@ -231,6 +386,76 @@ class [[eosio::contract("ystar.token")]] ystartoken : public contract {
                       const asset&   value,
                       const string&  memo );
       
+      /**
+       * This action will register the symbol of an existing token in assetkind,
+       * so that the symno variants of the actions can find it. Anyone can call it.
+       *
+       * @param value - in order to get the symbol of currency.
+       */
+      [[eosio::action]]
+      void regsymno( const asset& value );
+
+      /**
+       * Same as `setextime`, the token is given by its symno.
+       *
+       * @param symno - symbol number of the token,
+       * @param time - the exchanging time.
+       */
+      [[eosio::action]]
+      void setextimeno( uint32_t symno, uint64_t time );
+
+      /**
+       * Same as `freezeacc`, the token is given by its symno.
+       *
+       * @param acc - the account to be frozen,
+       * @param symno - symbol number of the token,
+       * @param time - freeze until this time.
+       */
+      [[eosio::action]]
+      void freezeno( const name&    acc,
+                     uint32_t       symno,
+                     uint64_t       time );
+
+      /**
+       * Same as `addaccbig`, the token is given by its symno.
+       *
+       * @param user - which account,
+       * @param symno - symbol number of the token.
+       */
+      [[eosio::action]]
+      void addbigno( const name&   user,
+                     uint32_t      symno );
+
+      /**
+       * Same as `lockasset`, the token is given by its symno.
+       *
+       * @param acc - the account to be locked,
+       * @param symno - symbol number of the token,
+       * @param amount - amount to lock,
+       * @param memo - the memo.
+       */
+      [[eosio::action]]
+      void lockno( const name&    acc,
+                   uint32_t       symno,
+                   int64_t        amount,
+                   const string&  memo );
+
+      /**
+       * Same as `batchpack`, the token is given by its symno.
+       *
+       * @param from - transfer from which account,
+       * @param symno - symbol number of the token,
+       * @param varamount - amounts are varuint64 encoded or not,
+       * @param memo - the memo,
+       * @param records - the packed (account, amount) records.
+       */
+      [[eosio::action]]
+      void batchno( const name&   from,
+                    uint32_t      symno,
+                    bool          varamount,
+                    const string& memo,
+                    ignore<std::vector<char>> records );
+
       static asset get_supply( const name& token_contract_account, const symbol_code& sym_code )
       {
          stats statstable( token_contract_account, sym_code.raw() );
@@ -250,98 +475,93 @@ class [[eosio::contract("ystar.token")]] ystartoken : public contract {
       using setextime_action = eosio::action_wrapper<"setextime"_n, &ystartoken::setextime>;
       using open_action = eosio::action_wrapper<"open"_n, &ystartoken::open>;
       using close_action = eosio::action_wrapper<"close"_n, &ystartoken::close>;
+      using setautoclose_action = eosio::action_wrapper<"setautoclose"_n, &ystartoken::setautoclose>;
+      using reclaim_action = eosio::action_wrapper<"reclaim"_n, &ystartoken::reclaim>;
       using yrctransfer_action = eosio::action_wrapper<"yrctransfer"_n, &ystartoken::yrctransfer>;
       using transfer_action = eosio::action_wrapper<"transfer"_n, &ystartoken::transfer>;
       using freezeacc_action = eosio::action_wrapper<"freezeacc"_n, &ystartoken::freezeacc>;
       using unfreezeacc_action = eosio::action_wrapper<"unfreezeacc"_n, &ystartoken::unfreezeacc>;
+      using pause_action = eosio::action_wrapper<"pause"_n, &ystartoken::pause>;
+      using unpause_action = eosio::action_wrapper<"unpause"_n, &ystartoken::unpause>;
+      using addpauseacc_action = eosio::action_wrapper<"addpauseacc"_n, &ystartoken::addpauseacc>;
+      using rmvpauseacc_action = eosio::action_wrapper<"rmvpauseacc"_n, &ystartoken::rmvpauseacc>;
       using addaccbig_action = eosio::action_wrapper<"addaccbig"_n, &ystartoken::addaccbig>;
       using rmvaccbig_action = eosio::action_wrapper<"rmvaccbig"_n, &ystartoken::rmvaccbig>;
       using addrule_action = eosio::action_wrapper<"addrule"_n, &ystartoken::addrule>;
+      using addlinrule_action = eosio::action_wrapper<"addlinrule"_n, &ystartoken::addlinrule>;
       using batchtrans_action = eosio::action_wrapper<"batchtrans"_n, &ystartoken::batchtrans>;
+      using batchpack_action = eosio::action_wrapper<"batchpack"_n, &ystartoken::batchpack>;
+      using addjob_action = eosio::action_wrapper<"addjob"_n, &ystartoken::addjob>;
+      using processjob_action = eosio::action_wrapper<"processjob"_n, &ystartoken::processjob>;
+      using addjobitems_action = eosio::action_wrapper<"addjobitems"_n, &ystartoken::addjobitems>;
+      using closejob_action = eosio::action_wrapper<"closejob"_n, &ystartoken::closejob>;
       using locktransfer_action = eosio::action_wrapper<"locktransfer"_n, &ystartoken::locktransfer>;
       using lockasset_action = eosio::action_wrapper<"lockasset"_n, &ystartoken::lockasset>;
+      using regsymno_action = eosio::action_wrapper<"regsymno"_n, &ystartoken::regsymno>;
+      using setextimeno_action = eosio::action_wrapper<"setextimeno"_n, &ystartoken::setextimeno>;
+      using freezeno_action = eosio::action_wrapper<"freezeno"_n, &ystartoken::freezeno>;
+      using addbigno_action = eosio::action_wrapper<"addbigno"_n, &ystartoken::addbigno>;
+      using lockno_action = eosio::action_wrapper<"lockno"_n, &ystartoken::lockno>;
+      using batchno_action = eosio::action_wrapper<"batchno"_n, &ystartoken::batchno>;
 
    private:
-      struct [[eosio::table]] account {
-         asset    balance;
-
-         uint64_t primary_key()const { return balance.symbol.code().raw(); }
-      };
-
-      struct [[eosio::table]] accfrozen {
-         name     user;
-         uint64_t time; //frozen deadline
-
-         uint64_t primary_key()const { return user.value; }
-      };
-
       struct [[eosio::table]] accbig {
          name     user;
 
          uint64_t primary_key()const { return user.value; }
       };
 
-      struct [[eosio::table]] currency_stat {
-         asset    supply;
-         asset    max_supply;
-         name     issuer;
-         name     ruler;
-         name     bigsetter;
-         name     locker;
-         name     freezer;
-         name     unfreezer;
-         uint64_t time = 0; //exchanging time
-         uint32_t symno; //symbol number in this contract
-
-         uint64_t primary_key()const { return supply.symbol.code().raw(); }
-      };
-
       struct [[eosio::table]] assetkind {
          uint32_t symno; //symbol number in this contract
+         binary_extension<symbol> sym; //symbol of this symno
 
          uint32_t primary_key()const { return symno; }
       };
 
-      struct [[eosio::table]] lockrule {
-         uint32_t                lockruleid;
-         std::vector<uint64_t>   times;
-         std::vector<uint16_t>   pcts; //lock percentage's numerator
-         uint32_t                base; //lock percentage's denominator
-         uint32_t                period;
-         string                  desc;
-
-         uint32_t                primary_key()const { return lockruleid; }
-      };
-
-      struct [[eosio::table]] acclock {
-         uint64_t        symruleid;
-         //uint32_t        lockruleid;  
-         int64_t         quantity;
-         name            user;
-         name            from;
-         uint64_t        time;
+      struct [[eosio::table]] batchjob {
+         uint32_t                jobid;
+         name                    from;
+         asset                   remaining; //debited but not paid yet
+         uint32_t                cursor = 0; //index of the next entry to pay
+         uint32_t                size = 0; //number of entries added
+         string                  memo;
 
-         uint32_t        primary_key()const { return symruleid; }
+         uint64_t                primary_key()const { return jobid; }
       };
 
-      struct [[eosio::table]] numlock {
-         name            user;
-         asset           quantity;
+      struct [[eosio::table]] jobentry {
+         uint64_t                key; //jobid << 32 | index of the entry
+         name                    user;
+         int64_t                 amount;
 
-         uint64_t        primary_key()const { return user.value; }
+         uint64_t                primary_key()const { return key; }
+         uint64_t                by_user()const { return user.value; }
       };
 
-      typedef eosio::multi_index< "accounts"_n, account > accounts;
-      typedef eosio::multi_index< "accfrozen"_n, accfrozen> accfrozens;
+      //tables other contracts read are in ystar.token.tables.hpp
+      typedef ystartoken_tables::currency_stat currency_stat;
+      typedef ystartoken_tables::accounts accounts;
+      typedef ystartoken_tables::accfrozens accfrozens;
+      typedef ystartoken_tables::pauseaccs pauseaccs;
+      typedef ystartoken_tables::stats stats;
+      typedef ystartoken_tables::lockrules lockrules;
+      typedef ystartoken_tables::linrules linrules;
+      typedef ystartoken_tables::acclocks acclocks;
+      typedef ystartoken_tables::numlocks numlocks;
       typedef eosio::multi_index< "accbig"_n, accbig> accbigs;
-      typedef eosio::multi_index< "stat"_n, currency_stat > stats;
       typedef eosio::multi_index< "assetkind"_n, assetkind > assetkinds;
-      typedef eosio::multi_index< "lockrule"_n, lockrule> lockrules;
-      typedef eosio::multi_index< "acclock"_n, acclock> acclocks;
-      typedef eosio::multi_index< "numlock"_n, numlock> numlocks;
+      typedef eosio::multi_index< "batchjob"_n, batchjob> batchjobs;
+      typedef eosio::multi_index< "jobentry"_n, jobentry,
+         indexed_by< "byuser"_n, const_mem_fun<jobentry, uint64_t, &jobentry::by_user> >
+      > jobentries;
 
       void sub_balance( const name& owner, const asset& value );
       void add_balance( uint64_t namevalue, uint64_t symbol, const asset& value, const name& ram_payer, bool bcreate );
+      symbol get_symno_symbol( uint32_t symno );
+      int64_t credit_packed( datastream<const char*>& ds, const symbol& sym, bool varamount,
+                             const name& ram_payer, bool bcreate );
+      void check_paused( const currency_stat& st, const name& from );
+      bool is_reclaimable( const name& owner, const currency_stat& st );
       bool is_frozen( const name&  user, const asset& value );
       asset get_lock_asset( const name& user, const asset& value );
 };
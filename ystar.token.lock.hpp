@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Lock math of ystar.token, free of any eosio dependency so that off-chain tools
+ * evaluate the very same formulas as `ystartoken_reader::get_locked_balance`.
+ * Every function returns the part of `amount` still locked at `curtime`.
+ */
+namespace ystarlock {
+
+   /**
+    * Locked amount of a `lockrule` row, a percentage ladder or, with one entry, lock by period.
+    */
+   inline int64_t rule_locked( int64_t amount, uint64_t extime, uint64_t curtime,
+                               const std::vector<uint64_t>& times, const std::vector<uint16_t>& pcts,
+                               uint32_t base, uint32_t period )
+   {
+      if ( extime == 0 || curtime <= extime )
+         return amount;
+
+      uint32_t percent = 0;
+      if ( times.size() == 1 ) { //lock by period
+         int64_t numerator = (int64_t)curtime - (int64_t)extime - (int64_t)times[0];
+         int64_t periods = numerator / (int64_t)period;
+         if (numerator > 0 && periods >= 1) {
+            percent = pcts[0] * periods;
+            if (percent < base) {
+               percent = base - percent;
+               return (int64_t)(((double)amount / base)*percent);
+            }
+            return 0;
+         }
+         return amount;
+      }
+
+      size_t n = 0;
+      for(auto itt = times.begin(); itt != times.end(); itt++) {
+         if( extime + *itt > curtime ) {
+               break;
+         }
+         percent = pcts[n];
+         n++;
+      }
+      percent = base - percent;
+      return (int64_t)(((double)amount / base)*percent);
+   }
+
+   /**
+    * Locked amount of a `linrule` row, nothing unlocks before the cliff, then linearly by granularity.
+    */
+   inline int64_t linear_locked( int64_t amount, uint64_t extime, uint64_t curtime,
+                                 uint64_t start, uint64_t cliff, uint64_t duration, uint64_t granularity )
+   {
+      if ( extime == 0 || curtime <= extime )
+         return amount;
+
+      int64_t elapsed = (int64_t)curtime - (int64_t)extime - (int64_t)start;
+      if ( elapsed <= 0 || elapsed < (int64_t)cliff )
+         return amount;
+      if ( elapsed >= (int64_t)duration )
+         return 0;
+
+      int64_t vested = elapsed / (int64_t)granularity * (int64_t)granularity;
+      return amount - (int64_t)((__int128)amount * vested / (int64_t)duration);
+   }
+
+} /// namespace ystarlock
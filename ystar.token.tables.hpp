@@ -0,0 +1,220 @@
+#pragma once
+
+#include <eosio/asset.hpp>
+#include <eosio/eosio.hpp>
+#include <eosio/system.hpp>
+
+#include <string>
+#include <vector>
+
+#include <ystar.token.lock.hpp>
+
+/**
+ * Tables of ystar.token read by the contract and by other contracts. Including this header
+ * does not pull in the contract class, `ystartoken_reader` gives what an account can spend.
+ */
+namespace ystartoken_tables {
+
+   using eosio::asset;
+   using eosio::name;
+
+   struct [[eosio::table, eosio::contract("ystar.token")]] account {
+      asset    balance;
+
+      uint64_t primary_key()const { return balance.symbol.code().raw(); }
+   };
+
+   struct [[eosio::table, eosio::contract("ystar.token")]] accfrozen {
+      name     user;
+      uint64_t time; //frozen deadline
+
+      uint64_t primary_key()const { return user.value; }
+   };
+
+   struct [[eosio::table, eosio::contract("ystar.token")]] pauseacc {
+      name     user;
+
+      uint64_t primary_key()const { return user.value; }
+   };
+
+   struct [[eosio::table, eosio::contract("ystar.token")]] currency_stat {
+      asset    supply;
+      asset    max_supply;
+      name     issuer;
+      name     ruler;
+      name     bigsetter;
+      name     locker;
+      name     freezer;
+      name     unfreezer;
+      uint64_t time = 0; //exchanging time
+      uint32_t symno; //symbol number in this contract
+      eosio::binary_extension<bool> paused; //all transfers are paused
+      eosio::binary_extension<bool> autoclose; //erase the row when balance drops to zero
+
+      uint64_t primary_key()const { return supply.symbol.code().raw(); }
+   };
+
+   struct [[eosio::table, eosio::contract("ystar.token")]] lockrule {
+      uint32_t                lockruleid;
+      std::vector<uint64_t>   times;
+      std::vector<uint16_t>   pcts; //lock percentage's numerator
+      uint32_t                base; //lock percentage's denominator
+      uint32_t                period;
+      std::string             desc;
+
+      uint32_t                primary_key()const { return lockruleid; }
+   };
+
+   struct [[eosio::table, eosio::contract("ystar.token")]] linrule {
+      uint32_t                lockruleid;
+      uint32_t                start; //seconds after the exchanging time
+      uint32_t                cliff; //seconds after start before anything unlocks
+      uint32_t                duration; //seconds after start when all is unlocked
+      uint32_t                granularity; //unlock step in seconds
+
+      uint32_t                primary_key()const { return lockruleid; }
+   };
+
+   struct [[eosio::table, eosio::contract("ystar.token")]] acclock {
+      uint64_t        symruleid;
+      //uint32_t        lockruleid;
+      int64_t         quantity;
+      name            user;
+      name            from;
+      uint64_t        time;
+
+      uint32_t        primary_key()const { return symruleid; }
+   };
+
+   struct [[eosio::table, eosio::contract("ystar.token")]] numlock {
+      name            user;
+      asset           quantity;
+
+      uint64_t        primary_key()const { return user.value; }
+   };
+
+   typedef eosio::multi_index< "accounts"_n, account > accounts;
+   typedef eosio::multi_index< "accfrozen"_n, accfrozen> accfrozens;
+   typedef eosio::multi_index< "pauseacc"_n, pauseacc> pauseaccs;
+   typedef eosio::multi_index< "stat"_n, currency_stat > stats;
+   typedef eosio::multi_index< "lockrule"_n, lockrule> lockrules;
+   typedef eosio::multi_index< "linrule"_n, linrule> linrules;
+   typedef eosio::multi_index< "acclock"_n, acclock> acclocks;
+   typedef eosio::multi_index< "numlock"_n, numlock> numlocks;
+
+} /// namespace ystartoken_tables
+
+/**
+ * Read only helpers giving the same answers the transfer path of ystar.token enforces.
+ * The `st` overloads take a stat row the caller has already loaded.
+ */
+namespace ystartoken_reader {
+
+   using namespace ystartoken_tables;
+   using eosio::symbol_code;
+
+   /**
+    * Returns the locked part of the balance, numlock plus the vesting locks of acclock,
+    * the same amount `sub_balance` keeps out of reach.
+    */
+   inline asset get_locked_balance( const name& token_contract_account, const currency_stat& st, const name& owner )
+   {
+      auto sym_code = st.supply.symbol.code();
+      asset lockasset( 0, st.supply.symbol );
+
+      numlocks _numlock( token_contract_account, sym_code.raw() );
+      auto il = _numlock.find( owner.value );
+      if( il != _numlock.end() )
+         lockasset.amount = il->quantity.amount;
+
+      acclocks _acclock( token_contract_account, owner.value  + (uint64_t)(sym_code.raw() & 0xf) );
+      lockrules _lockrule( token_contract_account, sym_code.raw() );
+      linrules _linrule( token_contract_account, sym_code.raw() );
+      uint64_t curtime = eosio::current_time_point().sec_since_epoch(); //seconds
+      uint64_t extime = st.time; //exchanging time
+      for(auto it = _acclock.begin(); it != _acclock.end(); it++) {
+         int64_t amount = it->quantity;
+
+         if ( (it->symruleid >> 32) != st.symno)
+            continue;
+
+         uint32_t ruleid = it->symruleid & 0xffffffff;
+         auto itrule = _lockrule.find(ruleid);
+         auto itlin = _linrule.end();
+         if ( itrule != _lockrule.end() ) {
+            lockasset.amount += ystarlock::rule_locked( amount, extime, curtime, itrule->times, itrule->pcts,
+                                                        itrule->base, itrule->period );
+         } else if ( (itlin = _linrule.find(ruleid)) != _linrule.end() ) {
+            lockasset.amount += ystarlock::linear_locked( amount, extime, curtime, itlin->start, itlin->cliff,
+                                                          itlin->duration, itlin->granularity );
+         } else {
+            lockasset.amount += amount;
+         }
+      }
+
+      return lockasset;
+   }
+
+   inline asset get_locked_balance( const name& token_contract_account, const name& owner, const symbol_code& sym_code )
+   {
+      stats statstable( token_contract_account, sym_code.raw() );
+      const auto& st = statstable.get( sym_code.raw(), "token is not existed" );
+      return get_locked_balance( token_contract_account, st, owner );
+   }
+
+   /**
+    * Returns true when the account is frozen for this token. Unlike the contract itself
+    * it never erases an expired frozen row.
+    */
+   inline bool is_account_frozen( const name& token_contract_account, const name& owner, const symbol_code& sym_code )
+   {
+      accfrozens _accfrozen( token_contract_account, sym_code.raw() );
+      auto it = _accfrozen.find( owner.value );
+      return it != _accfrozen.end() && eosio::current_time_point().sec_since_epoch() < it->time;
+   }
+
+   /**
+    * Returns true when the token is paused and the owner is not in its allow list,
+    * the same check transfers make.
+    */
+   inline bool is_blocked_by_pause( const name& token_contract_account, const currency_stat& st, const name& owner )
+   {
+      //the allow list is only read while the token is paused
+      if( !st.paused.value_or() )
+         return false;
+      pauseaccs _pauseacc( token_contract_account, st.supply.symbol.code().raw() );
+      return _pauseacc.find( owner.value ) == _pauseacc.end();
+   }
+
+   inline bool is_blocked_by_pause( const name& token_contract_account, const name& owner, const symbol_code& sym_code )
+   {
+      stats statstable( token_contract_account, sym_code.raw() );
+      const auto& st = statstable.get( sym_code.raw(), "token is not existed" );
+      return is_blocked_by_pause( token_contract_account, st, owner );
+   }
+
+   /**
+    * Returns what the account can transfer right now, zero while it is frozen or blocked by a pause.
+    */
+   inline asset get_spendable_balance( const name& token_contract_account, const name& owner, const symbol_code& sym_code )
+   {
+      stats statstable( token_contract_account, sym_code.raw() );
+      const auto& st = statstable.get( sym_code.raw(), "token is not existed" );
+      asset spendable( 0, st.supply.symbol );
+
+      //a missing row is a zero balance, autoclose erases drained rows
+      accounts accountstable( token_contract_account, owner.value );
+      auto ac = accountstable.find( sym_code.raw() );
+      if( ac == accountstable.end() || ac->balance.amount <= 0 )
+         return spendable;
+      if( is_account_frozen( token_contract_account, owner, sym_code )
+          || is_blocked_by_pause( token_contract_account, st, owner ) )
+         return spendable;
+
+      auto lockasset = get_locked_balance( token_contract_account, st, owner );
+      if( ac->balance.amount > lockasset.amount )
+         spendable.amount = ac->balance.amount - lockasset.amount;
+      return spendable;
+   }
+
+} /// namespace ystartoken_reader